@@ -0,0 +1,36 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <vector>
+
+#include "Csr.h"
+
+class Graph;
+
+// Centrality scores over a CsrSnapshot of a graph. Every score vector is
+// indexed like Graph::getNodes(), so result[i] belongs to getNodes()[i].
+// Distances follow outgoing edges and every kernel spreads its work over
+// all hardware threads.
+class Analytics {
+public:
+    explicit Analytics(const Graph& graph);
+
+    int size() const;
+
+    std::vector<double> pageRank(double damping = 0.85, int maxIterations = 100, double tolerance = 1e-6) const;
+
+    std::vector<double> degreeCentrality() const;
+
+    std::vector<double> closenessCentrality() const;
+
+    std::vector<double> betweennessCentrality() const;
+
+private:
+    CsrSnapshot adjacency;
+
+    // Transpose of the above, used by the pull-based PageRank.
+    CsrSnapshot reverse;
+};
+
+
+#endif
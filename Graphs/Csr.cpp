@@ -0,0 +1,113 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "Graphs.h"
+#include "Csr.h"
+
+std::vector<int> indexByID(const std::vector<std::shared_ptr<Node>>& nodes) {
+    int maxID = -1;
+    for (const auto& node : nodes) {
+        maxID = std::max(maxID, node->getID());
+    }
+    std::vector<int> indexOf(maxID + 1, -1);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        indexOf[nodes[i]->getID()] = static_cast<int>(i);
+    }
+    return indexOf;
+}
+
+CsrSnapshot::CsrSnapshot(const Graph& graph) : directed(graph.isDirected()) {
+    const auto& nodes = graph.getNodes();
+    int numNodes = static_cast<int>(nodes.size());
+
+    // Node IDs are dense but not necessarily equal to positions, so translate once.
+    indexOf = indexByID(nodes);
+
+    offsetsByNode.assign(numNodes + 1, 0);
+    for (int i = 0; i < numNodes; ++i) {
+        int valid = 0;
+        for (const auto& neighbor : nodes[i]->getNeighbors()) {
+            valid += index(neighbor->getID()) >= 0 ? 1 : 0;
+        }
+        offsetsByNode[i + 1] = offsetsByNode[i] + valid;
+    }
+    targetsByEdge.resize(offsetsByNode[numNodes]);
+    for (int i = 0; i < numNodes; ++i) {
+        int slot = offsetsByNode[i];
+        for (const auto& neighbor : nodes[i]->getNeighbors()) {
+            int target = index(neighbor->getID());
+            if (target >= 0) {
+                targetsByEdge[slot++] = target;
+            }
+        }
+    }
+}
+
+int CsrSnapshot::size() const {
+    return static_cast<int>(offsetsByNode.size()) - 1;
+}
+
+bool CsrSnapshot::isDirected() const {
+    return directed;
+}
+
+int CsrSnapshot::index(int id) const {
+    return id >= 0 && id < static_cast<int>(indexOf.size()) ? indexOf[id] : -1;
+}
+
+int CsrSnapshot::degree(int v) const {
+    return offsetsByNode[v + 1] - offsetsByNode[v];
+}
+
+const std::vector<int>& CsrSnapshot::offsets() const {
+    return offsetsByNode;
+}
+
+const std::vector<int>& CsrSnapshot::targets() const {
+    return targetsByEdge;
+}
+
+CsrSnapshot CsrSnapshot::transpose() const {
+    int numNodes = size();
+
+    CsrSnapshot reversed;
+    reversed.directed = directed;
+    reversed.indexOf = indexOf;
+    reversed.offsetsByNode.assign(numNodes + 1, 0);
+    for (int target : targetsByEdge) {
+        reversed.offsetsByNode[target + 1]++;
+    }
+    for (int i = 0; i < numNodes; ++i) {
+        reversed.offsetsByNode[i + 1] += reversed.offsetsByNode[i];
+    }
+
+    reversed.targetsByEdge.resize(targetsByEdge.size());
+    std::vector<int> cursor(reversed.offsetsByNode.begin(), reversed.offsetsByNode.end() - 1);
+    for (int i = 0; i < numNodes; ++i) {
+        for (int e = offsetsByNode[i]; e < offsetsByNode[i + 1]; ++e) {
+            reversed.targetsByEdge[cursor[targetsByEdge[e]]++] = i;
+        }
+    }
+    return reversed;
+}
+
+int CsrSnapshot::bfs(int source, std::vector<int>& distance, std::vector<int>& queue) const {
+    std::fill(distance.begin(), distance.end(), -1);
+    distance[source] = 0;
+    queue[0] = source;
+    int head = 0;
+    int tail = 1;
+    while (head < tail) {
+        int current = queue[head++];
+        for (int e = offsetsByNode[current]; e < offsetsByNode[current + 1]; ++e) {
+            int neighbor = targetsByEdge[e];
+            if (distance[neighbor] < 0) {
+                distance[neighbor] = distance[current] + 1;
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+    return tail;
+}
@@ -0,0 +1,51 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <memory>
+#include <vector>
+
+class Graph;
+class Node;
+
+// Position in `nodes` for every node ID, -1 for IDs not among them.
+std::vector<int> indexByID(const std::vector<std::shared_ptr<Node>>& nodes);
+
+// Read-only copy of a graph's adjacency in compressed sparse row form, indexed
+// like Graph::getNodes(). Neighbors that are no longer in the graph (a directed
+// in-link can outlive its node) are left out. Rebuild after the graph changes.
+class CsrSnapshot {
+public:
+    explicit CsrSnapshot(const Graph& graph);
+
+    int size() const;
+
+    bool isDirected() const;
+
+    // Position of the node with this ID, or -1.
+    int index(int id) const;
+
+    int degree(int v) const;
+
+    // Neighbors of node v are targets()[offsets()[v] .. offsets()[v + 1]).
+    const std::vector<int>& offsets() const;
+
+    const std::vector<int>& targets() const;
+
+    // Same nodes with every edge reversed; for an undirected graph, an equal copy.
+    CsrSnapshot transpose() const;
+
+    // Hop distances from `source`, -1 where unreached. queue[0 .. returned count) holds
+    // the reached nodes in visit order. Both vectors must have size() entries.
+    int bfs(int source, std::vector<int>& distance, std::vector<int>& queue) const;
+
+private:
+    CsrSnapshot() = default;
+
+    bool directed = false;
+    std::vector<int> indexOf;
+    std::vector<int> offsetsByNode;
+    std::vector<int> targetsByEdge;
+};
+
+
+#endif
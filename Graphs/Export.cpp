@@ -0,0 +1,248 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Graphs.h"
+#include "Export.h"
+
+namespace {
+
+bool writeAll(int fd, const char* data, std::size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int written = _write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(length, 1u << 30)));
+#else
+        ssize_t written = ::write(fd, data, length);
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+int openForWriting(const std::string& path) {
+#ifdef _WIN32
+    int fd = -1;
+    _sopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+    return fd;
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+}
+
+void closeDescriptor(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+sf::Vector2f centreOf(const Node& node) {
+    const sf::CircleShape& circle = node.getCircle();
+    return circle.getPosition() + sf::Vector2f(circle.getRadius(), circle.getRadius());
+}
+
+// Calls edge(source, target) once per edge; undirected pairs are reported from the lower ID.
+template <typename EdgeFn>
+void forEachEdge(const Graph& graph, EdgeFn edge) {
+    bool directed = graph.isDirected();
+    for (const auto& node : graph.getNodes()) {
+        for (const auto& neighbor : node->getNeighbors()) {
+            if (directed || node->getID() < neighbor->getID()) {
+                edge(*node, *neighbor);
+            }
+        }
+    }
+}
+
+void writeDot(const Graph& graph, OutputBuffer& out) {
+    const char* connector = graph.isDirected() ? " -> " : " -- ";
+    out << (graph.isDirected() ? "digraph G {\n" : "graph G {\n");
+    for (const auto& node : graph.getNodes()) {
+        sf::Vector2f centre = centreOf(*node);
+        out << "  " << node->getID() << " [pos=\"" << centre.x << ',' << centre.y << "\"];\n";
+    }
+    forEachEdge(graph, [&](const Node& source, const Node& target) {
+        out << "  " << source.getID() << connector << target.getID() << ";\n";
+    });
+    out << "}\n";
+}
+
+void writeGraphML(const Graph& graph, OutputBuffer& out) {
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+        << "  <key id=\"x\" for=\"node\" attr.name=\"x\" attr.type=\"float\"/>\n"
+        << "  <key id=\"y\" for=\"node\" attr.name=\"y\" attr.type=\"float\"/>\n"
+        << "  <graph id=\"G\" edgedefault=\"" << (graph.isDirected() ? "directed" : "undirected") << "\">\n";
+    for (const auto& node : graph.getNodes()) {
+        sf::Vector2f centre = centreOf(*node);
+        out << "    <node id=\"n" << node->getID() << "\"><data key=\"x\">" << centre.x
+            << "</data><data key=\"y\">" << centre.y << "</data></node>\n";
+    }
+    forEachEdge(graph, [&](const Node& source, const Node& target) {
+        out << "    <edge source=\"n" << source.getID() << "\" target=\"n" << target.getID() << "\"/>\n";
+    });
+    out << "  </graph>\n</graphml>\n";
+}
+
+void writeEdgeList(const Graph& graph, OutputBuffer& out) {
+    forEachEdge(graph, [&](const Node& source, const Node& target) {
+        out << source.getID() << ' ' << target.getID() << '\n';
+    });
+}
+
+void writeJson(const Graph& graph, OutputBuffer& out) {
+    out << "{\"directed\":" << (graph.isDirected() ? "true" : "false") << ",\"nodes\":[";
+    bool first = true;
+    for (const auto& node : graph.getNodes()) {
+        sf::Vector2f centre = centreOf(*node);
+        out << (first ? "\n" : ",\n") << "{\"id\":" << node->getID() << ",\"x\":" << centre.x << ",\"y\":" << centre.y << '}';
+        first = false;
+    }
+    out << "],\"edges\":[";
+    first = true;
+    forEachEdge(graph, [&](const Node& source, const Node& target) {
+        out << (first ? "\n" : ",\n") << "{\"source\":" << source.getID() << ",\"target\":" << target.getID() << '}';
+        first = false;
+    });
+    out << "]}\n";
+}
+
+}
+
+OutputBuffer::OutputBuffer(int fd, std::size_t capacity) : fd(fd), buffer(std::max<std::size_t>(capacity, 64)) {
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+void OutputBuffer::write(const char* data, std::size_t length) {
+    if (length > buffer.size()) {
+        flush();
+        if (!failed && !writeAll(fd, data, length)) {
+            failed = true;
+        }
+        return;
+    }
+    reserve(length);
+    std::memcpy(buffer.data() + used, data, length);
+    used += length;
+}
+
+void OutputBuffer::flush() {
+    if (used > 0 && !failed && !writeAll(fd, buffer.data(), used)) {
+        failed = true;
+    }
+    used = 0;
+}
+
+bool OutputBuffer::good() const {
+    return !failed;
+}
+
+void OutputBuffer::reserve(std::size_t length) {
+    if (buffer.size() - used < length) {
+        flush();
+    }
+}
+
+OutputBuffer& OutputBuffer::operator<<(char c) {
+    reserve(1);
+    buffer[used++] = c;
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const char* text) {
+    write(text, std::strlen(text));
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const std::string& text) {
+    write(text.data(), text.size());
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(float value) {
+    reserve(32);
+    auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+    used = result.ptr - buffer.data();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(double value) {
+    reserve(32);
+    auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+    used = result.ptr - buffer.data();
+    return *this;
+}
+
+void exportGraph(const Graph& graph, ExportFormat format, OutputBuffer& out) {
+    switch (format) {
+    case DotFormat:
+        writeDot(graph, out);
+        break;
+    case GraphMLFormat:
+        writeGraphML(graph, out);
+        break;
+    case EdgeListFormat:
+        writeEdgeList(graph, out);
+        break;
+    case JsonFormat:
+        writeJson(graph, out);
+        break;
+    }
+}
+
+bool exportGraph(const Graph& graph, ExportFormat format, const std::string& path) {
+    int fd = openForWriting(path);
+    if (fd < 0) {
+        std::cout << "ERROR: cannot open " << path << std::endl;
+        return false;
+    }
+
+    bool ok;
+    {
+        OutputBuffer out(fd);
+        exportGraph(graph, format, out);
+        out.flush();
+        ok = out.good();
+    }
+    closeDescriptor(fd);
+
+    if (!ok) {
+        std::cout << "ERROR: failed writing " << path << std::endl;
+    }
+    return ok;
+}
+
+const char* exportExtension(ExportFormat format) {
+    switch (format) {
+    case DotFormat:
+        return ".dot";
+    case GraphMLFormat:
+        return ".graphml";
+    case EdgeListFormat:
+        return ".txt";
+    case JsonFormat:
+        return ".json";
+    }
+    return "";
+}
@@ -0,0 +1,69 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class Graph;
+
+// Accumulates text in one large buffer and hands it to a file descriptor in
+// big chunks. Numbers are formatted with std::to_chars, so nothing here
+// touches locales or iostreams.
+class OutputBuffer {
+public:
+    explicit OutputBuffer(int fd, std::size_t capacity = 1 << 20);
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    ~OutputBuffer();
+
+    void write(const char* data, std::size_t length);
+
+    void flush();
+
+    // False once a write to the descriptor has failed; later output is dropped.
+    bool good() const;
+
+    OutputBuffer& operator<<(char c);
+
+    OutputBuffer& operator<<(const char* text);
+
+    OutputBuffer& operator<<(const std::string& text);
+
+    OutputBuffer& operator<<(float value);
+
+    OutputBuffer& operator<<(double value);
+
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value>>
+    OutputBuffer& operator<<(T value) {
+        reserve(24);
+        auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+        used = result.ptr - buffer.data();
+        return *this;
+    }
+
+private:
+    int fd;
+    bool failed = false;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+
+    // Makes room for `length` more bytes, flushing first if needed.
+    void reserve(std::size_t length);
+};
+
+enum ExportFormat { DotFormat, GraphMLFormat, EdgeListFormat, JsonFormat };
+
+// Node positions are exported as circle centres. Undirected edges are written once.
+void exportGraph(const Graph& graph, ExportFormat format, OutputBuffer& out);
+
+bool exportGraph(const Graph& graph, ExportFormat format, const std::string& path);
+
+const char* exportExtension(ExportFormat format);
+
+
+#endif
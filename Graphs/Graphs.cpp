@@ -2,13 +2,18 @@
 #include <vector>
 #include <memory>
 #include <iostream>
-#include <cstdlib>
+#include <cstdio>
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <cstdint>
 
 #include "Graphs.h"
 #include "Font.h"
+#include "Export.h"
+#include "Parallel.h"
+#include "Landmarks.h"
+#include "Csr.h"
 #include <queue>
 
     Node::Node(sf::Vector2f position) : id(nextID++) {
@@ -44,12 +49,26 @@
         }
     }
 
+    void Node::reserveNeighbors(std::size_t extra) {
+        neighbors.reserve(neighbors.size() + extra);
+    }
+
+    void Node::appendNeighbor(const std::shared_ptr<Node>& neighbor) {
+        neighbors.emplace_back(neighbor);
+    }
+
+    void Node::removeNeighborsIf(const std::function<bool(const Node&)>& predicate) {
+        neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [&](const std::shared_ptr<Node>& neighbor) {
+            return predicate(*neighbor);
+            }), neighbors.end());
+    }
+
     const std::vector<std::shared_ptr<Node>>& Node::getNeighbors() const {
         return neighbors;
     }
 
-    void Node::draw(sf::RenderWindow& window) const {
-        window.draw(circle);
+    void Node::draw(sf::RenderTarget& target) const {
+        target.draw(circle);
 
         sf::Font font;
         
@@ -70,7 +89,7 @@
         idText.setOrigin(textBounds.left + textBounds.width / 2.0f, textBounds.top + textBounds.height / 2.0f);
         idText.setPosition(circle.getPosition() + sf::Vector2f(circle.getRadius(), circle.getRadius()));
 
-        window.draw(idText);
+        target.draw(idText);
     }
 
 int Node::nextID = 0;
@@ -78,13 +97,35 @@ int Node::nextID = 0;
 
 
 std::shared_ptr<Node> Graph::addNode(sf::Vector2f position) {
+    oracle.reset();
     auto newNode = std::make_shared<Node>(position);
     nodes.push_back(newNode);
     placementHistory.push_back(NodePl);
+    placementRanges.emplace_back(nodes.size() - 1, 1);
     return newNode;
 }
 
+int Graph::addNodes(const std::vector<sf::Vector2f>& positions, bool journal) {
+    oracle.reset();
+    int firstID = Node::nextID;
+    if (positions.empty()) {
+        return firstID;
+    }
+
+    std::size_t first = nodes.size();
+    nodes.reserve(nodes.size() + positions.size());
+    for (const auto& position : positions) {
+        nodes.push_back(std::make_shared<Node>(position));
+    }
+    if (journal) {
+        placementHistory.push_back(NodeBatchPl);
+        placementRanges.emplace_back(first, positions.size());
+    }
+    return firstID;
+}
+
 void Graph::pop_nodes() {
+    oracle.reset();
     nodes.pop_back();
 }
 
@@ -98,14 +139,101 @@ bool Graph::hasEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<No
 
 void Graph::addEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2) {
     if (node1 != node2 && !hasEdge(node1, node2)) {
+        oracle.reset();
         edges.push_back({ node1, node2 });
         node1->addNeighbor(node2);
         node2->addNeighbor(node1);
         placementHistory.push_back(EdgePl);
+        placementRanges.emplace_back(edges.size() - 1, 1);
+    }
+}
+
+std::size_t Graph::addEdges(const std::vector<std::pair<int, int>>& pairs, bool journal) {
+    oracle.reset();
+    bool directed = isDirected();
+
+    std::vector<int> indexOf = indexByID(nodes);
+    auto lookup = [&](int id) {
+        return id >= 0 && id < static_cast<int>(indexOf.size()) ? indexOf[id] : -1;
+    };
+
+    // Pack each edge as (source index << 32 | target index) so sorting groups edges by source.
+    std::vector<std::uint64_t> keys;
+    keys.reserve(pairs.size());
+    for (const auto& pair : pairs) {
+        int source = lookup(pair.first);
+        int target = lookup(pair.second);
+        if (source < 0 || target < 0 || source == target) {
+            continue;
+        }
+        if (!directed && source > target) {
+            std::swap(source, target);
+        }
+        keys.push_back((static_cast<std::uint64_t>(source) << 32) | static_cast<std::uint32_t>(target));
+    }
+
+    parallelSort(keys);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // Drop edges the graph already has: stamp each source's current neighbors once,
+    // then test every new edge of that source against the stamps.
+    std::vector<int> stamp(nodes.size(), -1);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < keys.size();) {
+        int source = static_cast<int>(keys[i] >> 32);
+        for (const auto& neighbor : nodes[source]->getNeighbors()) {
+            int index = lookup(neighbor->getID());
+            if (index >= 0) {
+                stamp[index] = source;
+            }
+        }
+        for (; i < keys.size() && static_cast<int>(keys[i] >> 32) == source; ++i) {
+            int target = static_cast<int>(keys[i] & 0xFFFFFFFFu);
+            if (stamp[target] != source) {
+                keys[kept++] = keys[i];
+            }
+        }
+    }
+    keys.resize(kept);
+
+    if (keys.empty()) {
+        return 0;
+    }
+
+    std::vector<std::size_t> added(nodes.size(), 0);
+    for (std::uint64_t key : keys) {
+        added[key >> 32]++;
+        if (!directed) {
+            added[key & 0xFFFFFFFFu]++;
+        }
+    }
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (added[i] > 0) {
+            nodes[i]->reserveNeighbors(added[i]);
+        }
+    }
+
+    std::size_t first = edges.size();
+    edges.reserve(edges.size() + keys.size());
+    for (std::uint64_t key : keys) {
+        const auto& source = nodes[key >> 32];
+        const auto& target = nodes[key & 0xFFFFFFFFu];
+        source->appendNeighbor(target);
+        if (!directed) {
+            target->appendNeighbor(source);
+        }
+        edges.push_back({ source, target });
+    }
+
+    if (journal) {
+        placementHistory.push_back(EdgeBatchPl);
+        placementRanges.emplace_back(first, keys.size());
     }
+    return keys.size();
 }
 
 void Graph::removeEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2) {
+    oracle.reset();
     node1->removeNeighbor(node2);
     node2->removeNeighbor(node1);
 
@@ -157,27 +285,47 @@ void Graph::addEdgeIfValid(const std::shared_ptr<Node>& node) {
 }
 
 int Graph::shortestPath(const Graph* graph, std::shared_ptr<Node> start, std::shared_ptr<Node> end) const {
+    if (graph->oracle) {
+        int length = graph->oracle->distance(start, end);
+        return length < 0 ? 0 : length;
+    }
+
     constexpr int INF = std::numeric_limits<int>::max();
     int numNodes = graph->getNodes().size();
 
+    // IDs can have gaps (an undone node keeps its ID reserved if newer nodes follow it),
+    // so memo is indexed by position, never by raw ID.
+    std::vector<int> indexOf = indexByID(graph->getNodes());
+    auto lookup = [&](const std::shared_ptr<Node>& node) {
+        int id = node->getID();
+        return id >= 0 && id < static_cast<int>(indexOf.size()) ? indexOf[id] : -1;
+    };
+
+    int startIndex = lookup(start);
+    int endIndex = lookup(end);
+    if (startIndex < 0 || endIndex < 0) {
+        return 0;
+    }
+
     std::vector<int> memo(numNodes, INF);
 
-    std::queue<std::shared_ptr<Node>> bfsQueue;
-    bfsQueue.push(start);
-    memo[start->getID()] = 0;
+    std::queue<int> bfsQueue;
+    bfsQueue.push(startIndex);
+    memo[startIndex] = 0;
 
     while (!bfsQueue.empty()) {
-        auto currentNode = bfsQueue.front();
+        int current = bfsQueue.front();
         bfsQueue.pop();
 
-        const auto& neighbors = currentNode->getNeighbors();
+        const auto& neighbors = graph->getNodes()[current]->getNeighbors();
         for (const auto& neighbor : neighbors) {
-            if (memo[neighbor->getID()] == INF) {
-                memo[neighbor->getID()] = memo[currentNode->getID()] + 1;
-                bfsQueue.push(neighbor);
+            int next = lookup(neighbor);
+            if (next >= 0 && memo[next] == INF) {
+                memo[next] = memo[current] + 1;
+                bfsQueue.push(next);
 
-                if (neighbor == end) {
-                    return memo[end->getID()];
+                if (next == endIndex) {
+                    return memo[endIndex];
                 }
             }
         }
@@ -189,84 +337,177 @@ int Graph::shortestPath(const Graph* graph, std::shared_ptr<Node> start, std::sh
 
 
 
+void Graph::buildDistanceOracle(int landmarks) {
+    oracle = std::make_shared<LandmarkOracle>(*this, landmarks);
+}
+
+const std::shared_ptr<const LandmarkOracle>& Graph::getDistanceOracle() const {
+    return oracle;
+}
+
 void Graph::info() const {
+    // Anything already queued through cout/stdio has to land before our raw writes.
+    std::fflush(stdout);
+    OutputBuffer out(1);
+
     for (const auto& node : nodes) {
-        std::cout << "Node ID: " << node->getID() << std::endl;
+        out << "Node ID: " << node->getID() << '\n';
         const auto& neighbors = node->getNeighbors();
-        std::cout << "Neighbors: ";
+        out << "Neighbors: ";
         if (neighbors.empty()) {
-            std::cout << "Empty " << std::endl;
+            out << "Empty \n";
         }
         else {
             for (const auto& neighbor : neighbors) {
-                std::cout << neighbor->getID() << " ";
+                out << neighbor->getID() << ' ';
             }
-            std::cout << std::endl;
+            out << '\n';
         }
-        std::cout << "-------------------" << std::endl;
+        out << "-------------------\n";
     }
     if (searchStartNode && searchEndNode) {
-        std::cout << "Shortest Path length is: " << shortestPath(this, searchStartNode, searchEndNode) << std::endl;
+        out << "Shortest Path length is: " << shortestPath(this, searchStartNode, searchEndNode) << '\n';
     }
 
-    std::cout << "-------------------" << std::endl;
+    out << "-------------------\n";
 }
 
-void Graph::draw(sf::RenderWindow& window) const {
+bool Graph::isDirected() const {
+    return false;
+}
+
+void Graph::draw(sf::RenderTarget& target) const {
     for (const auto& node : nodes) {
-        node->draw(window);
+        node->draw(target);
         const auto& neighbors = node->getNeighbors();
         for (const auto& neighbor : neighbors) {
             sf::Vertex line[] = {
                 sf::Vertex(node->getCircle().getPosition() + sf::Vector2f(node->getCircle().getRadius(), node->getCircle().getRadius())),
                 sf::Vertex(neighbor->getCircle().getPosition() + sf::Vector2f(neighbor->getCircle().getRadius(), neighbor->getCircle().getRadius()))
             };
-            window.draw(line, 2, sf::Lines);
+            target.draw(line, 2, sf::Lines);
         }
     }
 }
 
 void Graph::clear() {
+    oracle.reset();
     nodes.clear();
+    edges.clear();
+    placementHistory.clear();
+    placementRanges.clear();
     startingNode.reset();
     Node::nextID = 0;
-    std::system("cls");
 }
 
 void Graph::undo() {
+    oracle.reset();
     if (!placementHistory.empty()) {
-        if (placementHistory.back() == NodePl) {
-            if (nodes.size() >= 1) {
-                auto lastNode = nodes.back();
-                for (const auto& neighbor : lastNode->getNeighbors()) {
-                    neighbor->removeNeighbor(lastNode);
-                }
-                nodes.pop_back();
-                Node::nextID--;
+        // Clamped in case pop_nodes() or removeEdge() shrank the vectors behind the journal's back.
+        std::size_t first = placementRanges.back().first;
+        std::size_t count = placementRanges.back().second;
+        if (placementHistory.back() == NodePl || placementHistory.back() == NodeBatchPl) {
+            if (first < nodes.size()) {
+                undoNodeBatch(first, std::min(count, nodes.size() - first));
             }
         }
-        else if (placementHistory.back() == EdgePl) {
-            if (!nodes.empty()) {
-                if (!edges.empty()) {
-                    const Edge& lastEdge = edges.back();
-                    edges.pop_back();
-                    removeEdge(lastEdge.node1, lastEdge.node2);
-                }
+        else if (placementHistory.back() == EdgePl || placementHistory.back() == EdgeBatchPl) {
+            if (first < edges.size()) {
+                undoEdgeBatch(first, std::min(count, edges.size() - first));
             }
         }
 
         placementHistory.pop_back();
+        placementRanges.pop_back();
     }
 }
 
+void Graph::undoNodeBatch(std::size_t first, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    std::size_t last = first + count;
+    int firstID = nodes[first]->getID();
+    int lastID = nodes[last - 1]->getID();
+    auto inBatch = [firstID, lastID](const Node& neighbor) {
+        return neighbor.getID() >= firstID && neighbor.getID() <= lastID;
+    };
+
+    // Undirected links are symmetric, so only the batch's own neighbors can point back
+    // into it. Directed in-links are invisible from the batch side and need a full scan.
+    if (isDirected()) {
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (i < first || i >= last) {
+                nodes[i]->removeNeighborsIf(inBatch);
+            }
+        }
+    }
+    else {
+        for (std::size_t i = first; i < last; ++i) {
+            for (const auto& neighbor : nodes[i]->getNeighbors()) {
+                if (!inBatch(*neighbor)) {
+                    neighbor->removeNeighborsIf(inBatch);
+                }
+            }
+        }
+    }
+
+    // Only unjournaled edges can still touch the batch; anything journaled after it was undone first.
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [&](const Edge& edge) {
+        return inBatch(*edge.node1) || inBatch(*edge.node2);
+        }), edges.end());
+
+    // IDs are only handed back when nothing was added after the batch.
+    bool atEnd = last == nodes.size() && lastID + 1 == Node::nextID;
+    nodes.erase(nodes.begin() + first, nodes.begin() + last);
+    if (atEnd) {
+        Node::nextID -= static_cast<int>(count);
+    }
+}
+
+void Graph::undoEdgeBatch(std::size_t first, std::size_t count) {
+    bool directed = isDirected();
+    std::size_t last = first + count;
+
+    // (owner ID, neighbor ID) for every adjacency entry the batch created.
+    std::vector<std::pair<int, int>> removed;
+    removed.reserve(directed ? count : 2 * count);
+    for (std::size_t i = first; i < last; ++i) {
+        removed.emplace_back(edges[i].node1->getID(), edges[i].node2->getID());
+        if (!directed) {
+            removed.emplace_back(edges[i].node2->getID(), edges[i].node1->getID());
+        }
+    }
+    parallelSort(removed);
+
+    std::vector<int> indexOf = indexByID(nodes);
+    for (auto range = removed.begin(); range != removed.end();) {
+        int id = range->first;
+        auto rangeEnd = std::find_if(range, removed.end(), [id](const std::pair<int, int>& entry) {
+            return entry.first != id;
+            });
+        nodes[indexOf[id]]->removeNeighborsIf([&](const Node& neighbor) {
+            return std::binary_search(range, rangeEnd, std::make_pair(id, neighbor.getID()));
+            });
+        range = rangeEnd;
+    }
+
+    edges.erase(edges.begin() + first, edges.begin() + last);
+}
 
 void DirectedGraph::addEdge(const std::shared_ptr<Node>& source, const std::shared_ptr<Node>& target) {
+    oracle.reset();
     source->addNeighbor(target);
 }
 
-void DirectedGraph::draw(sf::RenderWindow& window) const {
+bool DirectedGraph::isDirected() const {
+    return true;
+}
+
+void DirectedGraph::draw(sf::RenderTarget& target) const {
     for (const auto& node : nodes) {
-        node->draw(window);
+        node->draw(target);
         const auto& neighbors = node->getNeighbors();
         for (const auto& neighbor : neighbors) {
             sf::Vector2f startPos = node->getCircle().getPosition() + sf::Vector2f(node->getCircle().getRadius(), node->getCircle().getRadius());
@@ -284,14 +525,14 @@ void DirectedGraph::draw(sf::RenderWindow& window) const {
                 sf::Vertex(startPos),
                 sf::Vertex(endPos - arrowOffset)
             };
-            window.draw(line, 2, sf::Lines);
+            target.draw(line, 2, sf::Lines);
 
             sf::Vertex arrowHead[] = {
                 sf::Vector2f(endPos - arrowOffset - unitDirection * arrowSize),
                 sf::Vector2f(endPos - arrowOffset - unitDirection * arrowSize - rotate(unitDirection, 45.0f) * arrowSize),
                 sf::Vector2f(endPos - arrowOffset - unitDirection * arrowSize - rotate(unitDirection, -45.0f) * arrowSize)
             };
-            window.draw(arrowHead, 3, sf::Triangles);
+            target.draw(arrowHead, 3, sf::Triangles);
         }
     }
 }
@@ -1,6 +1,9 @@
 #ifndef GRAPHS_H
 #define GRAPHS_H
 
+#include <functional>
+
+class LandmarkOracle;
 
 class Node {
 private:
@@ -22,9 +25,16 @@ public:
 
     void removeNeighbor(const std::shared_ptr<Node>& neighbor);
 
+    void reserveNeighbors(std::size_t extra);
+
+    // Bulk path: the caller has already ruled out duplicates.
+    void appendNeighbor(const std::shared_ptr<Node>& neighbor);
+
+    void removeNeighborsIf(const std::function<bool(const Node&)>& predicate);
+
     const std::vector<std::shared_ptr<Node>>& getNeighbors() const;
 
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
 };
 
 class Graph {
@@ -41,23 +51,44 @@ protected:
 
     std::vector<Edge> edges;
 
+    // Built on request by buildDistanceOracle(); any mutation drops it.
+    std::shared_ptr<const LandmarkOracle> oracle;
 
-    enum Type { NodePl, EdgePl };
+
+    enum Type { NodePl, EdgePl, NodeBatchPl, EdgeBatchPl };
 
 
     std::vector<Type> placementHistory;  // History of node and edge placements
+    // (first position in nodes/edges, count) of each placementHistory entry. Unjournaled
+    // additions can land after an entry, so undo can't just trim the back.
+    std::vector<std::pair<std::size_t, std::size_t>> placementRanges;
+
+    void undoNodeBatch(std::size_t first, std::size_t count);
+
+    void undoEdgeBatch(std::size_t first, std::size_t count);
 
 
 
 public:
     std::shared_ptr<Node> addNode(sf::Vector2f position);
 
+    // Adds one node per position with consecutive IDs and returns the first ID.
+    // The whole batch is a single undo step, or no step at all without `journal`
+    // (for data streamed in rather than placed by the user).
+    int addNodes(const std::vector<sf::Vector2f>& positions, bool journal = true);
+
     void pop_nodes();
 
     bool hasEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2) const;
 
     virtual void addEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2);
 
+    // Connects pairs of node IDs. Self-loops, unknown IDs, repeats within the batch and
+    // edges the graph already has are dropped by one sort + unique pass rather than a
+    // hasEdge() per pair. Returns how many edges were added; the batch is a single undo
+    // step unless `journal` is false.
+    std::size_t addEdges(const std::vector<std::pair<int, int>>& pairs, bool journal = true);
+
     void removeEdge(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2);
 
     const std::vector<std::shared_ptr<Node>>& getNodes() const;
@@ -78,9 +109,16 @@ public:
 
     int shortestPath(const Graph* graph, std::shared_ptr<Node> start, std::shared_ptr<Node> end) const;
 
+    // Precomputes landmark distance tables so shortestPath() becomes a bounded A* search.
+    void buildDistanceOracle(int landmarks = 16);
+
+    const std::shared_ptr<const LandmarkOracle>& getDistanceOracle() const;
+
     void info() const;
 
-    virtual void draw(sf::RenderWindow& window) const;
+    virtual bool isDirected() const;
+
+    virtual void draw(sf::RenderTarget& target) const;
 
     void clear();
 
@@ -92,7 +130,9 @@ class DirectedGraph : public Graph {
 public:
     void addEdge(const std::shared_ptr<Node>& source, const std::shared_ptr<Node>& target);
 
-    void draw(sf::RenderWindow& window) const override;
+    bool isDirected() const override;
+
+    void draw(sf::RenderTarget& target) const override;
 
 private:
     sf::Vector2f rotate(const sf::Vector2f& vector, float angle) const;
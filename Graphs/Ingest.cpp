@@ -0,0 +1,193 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "Graphs.h"
+#include "Ingest.h"
+
+std::size_t IngestQueue::Chunk::size() const {
+    return nodes.size() + edges.size();
+}
+
+IngestQueue::Producer::Producer(IngestQueue& queue) : queue(&queue) {
+}
+
+IngestQueue::Producer::Producer(Producer&& other) noexcept : queue(other.queue), chunk(std::move(other.chunk)) {
+    other.queue = nullptr;
+}
+
+IngestQueue::Producer& IngestQueue::Producer::operator=(Producer&& other) noexcept {
+    if (this != &other) {
+        flush();
+        queue = other.queue;
+        chunk = std::move(other.chunk);
+        other.queue = nullptr;
+    }
+    return *this;
+}
+
+IngestQueue::Producer::~Producer() {
+    flush();
+}
+
+IngestQueue::NodeRef IngestQueue::Producer::addNode(sf::Vector2f position) {
+    ensureChunk();
+    // A chunk never holds more than chunkCapacity items, so handles of different chunks can't collide.
+    NodeRef ref = -(chunk->sequence * static_cast<std::int64_t>(queue->chunkCapacity) + static_cast<std::int64_t>(chunk->nodes.size())) - 1;
+    chunk->nodes.push_back(position);
+    publishIfFull();
+    return ref;
+}
+
+void IngestQueue::Producer::addEdge(NodeRef source, NodeRef target) {
+    ensureChunk();
+    chunk->edges.emplace_back(source, target);
+    publishIfFull();
+}
+
+void IngestQueue::Producer::flush() {
+    if (queue && chunk && chunk->size() > 0) {
+        queue->publish(std::move(chunk));
+    }
+}
+
+void IngestQueue::Producer::ensureChunk() {
+    if (!chunk) {
+        chunk = std::make_unique<Chunk>();
+        chunk->sequence = queue->nextSequence.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void IngestQueue::Producer::publishIfFull() {
+    if (chunk->size() >= queue->chunkCapacity) {
+        queue->publish(std::move(chunk));
+    }
+}
+
+IngestQueue::IngestQueue(std::size_t chunkCapacity) : chunkCapacity(std::max<std::size_t>(1, chunkCapacity)) {
+}
+
+IngestQueue::~IngestQueue() {
+    Chunk* chunk = published.exchange(nullptr, std::memory_order_acquire);
+    while (chunk) {
+        std::unique_ptr<Chunk> owned(chunk);
+        chunk = chunk->next;
+    }
+}
+
+IngestQueue::Producer IngestQueue::producer() {
+    return Producer(*this);
+}
+
+void IngestQueue::publish(std::unique_ptr<Chunk> chunk) {
+    // Treiber push. Only pushes race here; the consumer takes the whole stack at once, so there is no ABA.
+    Chunk* node = chunk.release();
+    node->next = published.load(std::memory_order_relaxed);
+    while (!published.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void IngestQueue::collect() {
+    Chunk* chunk = published.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack hands chunks back newest first; restore publication order.
+    std::vector<Chunk*> taken;
+    for (; chunk; chunk = chunk->next) {
+        taken.push_back(chunk);
+    }
+    for (auto it = taken.rbegin(); it != taken.rend(); ++it) {
+        pending.emplace_back(*it);
+    }
+}
+
+int IngestQueue::resolve(NodeRef ref) const {
+    if (ref >= 0) {
+        return static_cast<int>(ref);
+    }
+    std::int64_t ticket = -(ref + 1);
+    std::int64_t sequence = ticket / static_cast<std::int64_t>(chunkCapacity);
+    int offset = static_cast<int>(ticket % static_cast<std::int64_t>(chunkCapacity));
+
+    // Every real handle's sequence was taken before the handle was returned, and the
+    // edge naming it was published after that, so a larger sequence never comes from here.
+    if (sequence >= nextSequence.load(std::memory_order_relaxed)) {
+        return Gone;
+    }
+    if (sequence >= static_cast<std::int64_t>(placements.size())) {
+        return Unmerged;
+    }
+    const Placement& placement = placements[sequence];
+    if (placement.firstID < 0) {
+        return placement.firstID;
+    }
+    return offset < placement.nodeCount ? placement.firstID + offset : Gone;
+}
+
+std::size_t IngestQueue::mergeInto(Graph& graph, std::size_t budget) {
+    collect();
+
+    std::vector<sf::Vector2f> nodes;
+    std::vector<std::int64_t> sequences;
+    std::vector<std::pair<NodeRef, NodeRef>> staged;
+    staged.swap(heldBack);
+    std::size_t merged = 0;
+    while (!pending.empty() && merged < budget) {
+        std::unique_ptr<Chunk> chunk = std::move(pending.front());
+        pending.pop_front();
+
+        // Recorded even without nodes, so a stray handle into this chunk is known to be bad.
+        if (chunk->sequence >= static_cast<std::int64_t>(placements.size())) {
+            placements.resize(chunk->sequence + 1);
+        }
+        placements[chunk->sequence].firstID = static_cast<int>(nodes.size());
+        placements[chunk->sequence].nodeCount = static_cast<int>(chunk->nodes.size());
+        sequences.push_back(chunk->sequence);
+
+        nodes.insert(nodes.end(), chunk->nodes.begin(), chunk->nodes.end());
+        staged.insert(staged.end(), chunk->edges.begin(), chunk->edges.end());
+        merged += chunk->size();
+    }
+
+    // Placements hold offsets into `nodes` until the batch has its IDs.
+    int firstID = nodes.empty() ? 0 : graph.addNodes(nodes, false);
+    for (std::int64_t sequence : sequences) {
+        placements[sequence].firstID += firstID;
+    }
+
+    // Producers publish independently, so an edge can arrive before the chunk holding
+    // another producer's node; keep it until that chunk is merged. Edges naming a node
+    // that is gone can never land and are dropped.
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(staged.size());
+    for (const auto& edge : staged) {
+        int source = resolve(edge.first);
+        int target = resolve(edge.second);
+        if (source == Gone || target == Gone) {
+            continue;
+        }
+        if (source < 0 || target < 0) {
+            heldBack.push_back(edge);
+        }
+        else {
+            edges.emplace_back(source, target);
+        }
+    }
+    if (!edges.empty()) {
+        graph.addEdges(edges, false);
+    }
+    return merged;
+}
+
+bool IngestQueue::empty() const {
+    return pending.empty() && heldBack.empty() && published.load(std::memory_order_acquire) == nullptr;
+}
+
+void IngestQueue::reset() {
+    // Held-back edges are re-checked on the next merge, so those naming cleared nodes go then.
+    for (Placement& placement : placements) {
+        if (placement.firstID >= 0) {
+            placement.firstID = Gone;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Graph;
+
+// Staging area that lets many threads feed nodes and edges into a Graph
+// owned by another thread. Each producer fills a private chunk without any
+// synchronisation and publishes full chunks to a lock-free stack; the owning
+// thread takes them at a safe point (e.g. between frames) and merges them
+// with the bulk addNodes/addEdges API.
+//
+// A staged node has no graph ID until it is merged, so Producer::addNode
+// returns a negative handle instead. addEdge takes either kind of endpoint:
+// a handle, or the ID of a node already in the graph.
+class IngestQueue {
+public:
+    using NodeRef = std::int64_t;
+
+private:
+    struct Chunk {
+        std::int64_t sequence;  // Handles of this chunk's nodes derive from it
+        std::vector<sf::Vector2f> nodes;
+        std::vector<std::pair<NodeRef, NodeRef>> edges;
+        Chunk* next = nullptr;
+
+        std::size_t size() const;
+    };
+
+public:
+    // One per producer thread. A Producer itself is not thread-safe, and the
+    // queue must outlive it. Anything still buffered is published on destruction.
+    class Producer {
+    public:
+        Producer(Producer&& other) noexcept;
+
+        Producer& operator=(Producer&& other) noexcept;
+
+        ~Producer();
+
+        // Returns a handle that addEdge accepts until the node is merged and after.
+        NodeRef addNode(sf::Vector2f position);
+
+        // Each endpoint is a handle from addNode (any producer of this queue) or a graph ID.
+        void addEdge(NodeRef source, NodeRef target);
+
+        // Publishes the current chunk even if it is not full yet.
+        void flush();
+
+    private:
+        friend class IngestQueue;
+
+        explicit Producer(IngestQueue& queue);
+
+        IngestQueue* queue;
+        std::unique_ptr<Chunk> chunk;
+
+        void ensureChunk();
+
+        void publishIfFull();
+    };
+
+    explicit IngestQueue(std::size_t chunkCapacity = 4096);
+
+    IngestQueue(const IngestQueue&) = delete;
+    IngestQueue& operator=(const IngestQueue&) = delete;
+
+    ~IngestQueue();
+
+    Producer producer();
+
+    // Owner thread only. Merges published chunks in arrival order until about
+    // `budget` items have been applied; the rest wait for the next call. All
+    // nodes of a merge are added before its edges. Merges bypass the undo
+    // journal, so Ctrl+Z keeps undoing the user's own edits. An edge whose
+    // handle names a node from a chunk that is not merged yet is held back and
+    // retried on later calls; one naming a node that is gone is dropped.
+    // Returns the number of items merged.
+    std::size_t mergeInto(Graph& graph, std::size_t budget = std::numeric_limits<std::size_t>::max());
+
+    // Owner thread only. True if nothing is published, waiting to be merged or held back.
+    bool empty() const;
+
+    // Owner thread only. Call after the graph is cleared: handles of nodes merged
+    // so far stop resolving, and edges naming them are dropped instead of being
+    // wired to whichever new nodes reuse their IDs. Chunks not merged yet still
+    // merge normally afterwards.
+    void reset();
+
+private:
+    std::size_t chunkCapacity;
+    std::atomic<std::int64_t> nextSequence{ 0 };
+    std::atomic<Chunk*> published{ nullptr };
+    std::deque<std::unique_ptr<Chunk>> pending;
+
+    static constexpr int Unmerged = -1;
+    static constexpr int Gone = -2;
+
+    struct Placement {
+        int firstID = Unmerged;  // Graph ID of the chunk's first node; Gone once reset() drops it
+        int nodeCount = 0;
+    };
+
+    // Owner thread only, indexed by chunk sequence.
+    std::vector<Placement> placements;
+    std::vector<std::pair<NodeRef, NodeRef>> heldBack;
+
+    void publish(std::unique_ptr<Chunk> chunk);
+
+    void collect();
+
+    // Graph ID for `ref`, Unmerged while its node is still staged, or Gone if it was
+    // cleared or never came from this queue.
+    int resolve(NodeRef ref) const;
+};
+
+
+#endif
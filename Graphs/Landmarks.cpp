@@ -0,0 +1,240 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <limits>
+
+#include "Graphs.h"
+#include "Landmarks.h"
+#include "Parallel.h"
+
+LandmarkOracle::LandmarkOracle(const Graph& graph, int landmarks, Strategy strategy) : directed(graph.isDirected()), adjacency(graph) {
+    int numNodes = adjacency.size();
+
+    k = std::max(0, std::min(landmarks, numNodes));
+    cost.assign(numNodes, 0);
+    seen.assign(numNodes, 0);
+    if (k == 0) {
+        return;
+    }
+
+    auto clamp = [](int hops) {
+        return hops < 0 ? Unreachable : static_cast<std::uint16_t>(std::min(hops, Unreachable - 1));
+    };
+
+    fromLandmark.assign(static_cast<std::size_t>(numNodes) * k, Unreachable);
+    std::vector<int> chosen;
+    chosen.reserve(k);
+
+    if (strategy == DegreeLandmarks) {
+        std::vector<int> order(numNodes);
+        for (int i = 0; i < numNodes; ++i) {
+            order[i] = i;
+        }
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](int a, int b) {
+            return adjacency.degree(a) > adjacency.degree(b);
+            });
+        chosen.assign(order.begin(), order.begin() + k);
+
+        parallelFor(k, parallelWorkers(k, 1), [&](std::size_t begin, std::size_t end, unsigned) {
+            std::vector<int> distance(numNodes);
+            std::vector<int> queue(numNodes);
+            for (std::size_t i = begin; i < end; ++i) {
+                adjacency.bfs(chosen[i], distance, queue);
+                for (int v = 0; v < numNodes; ++v) {
+                    fromLandmark[static_cast<std::size_t>(v) * k + i] = clamp(distance[v]);
+                }
+            }
+        });
+    }
+    else {
+        // Farthest-point: start at the busiest node, then repeatedly take the node farthest
+        // from every landmark so far. Nodes no landmark reaches rank last, so a few stray
+        // isolated nodes can't soak up the landmark budget; another component only gets a
+        // landmark once the first is exhausted.
+        std::vector<int> nearest(numNodes, std::numeric_limits<int>::max());
+        std::vector<int> distance(numNodes);
+        std::vector<int> queue(numNodes);
+
+        int next = 0;
+        for (int v = 1; v < numNodes; ++v) {
+            if (adjacency.degree(v) > adjacency.degree(next)) {
+                next = v;
+            }
+        }
+
+        for (int i = 0; i < k; ++i) {
+            chosen.push_back(next);
+            adjacency.bfs(next, distance, queue);
+            for (int v = 0; v < numNodes; ++v) {
+                fromLandmark[static_cast<std::size_t>(v) * k + i] = clamp(distance[v]);
+                if (distance[v] >= 0) {
+                    nearest[v] = std::min(nearest[v], distance[v]);
+                }
+            }
+            nearest[next] = -1;
+
+            next = static_cast<int>(std::max_element(nearest.begin(), nearest.end(), [](int a, int b) {
+                return (a == std::numeric_limits<int>::max() ? 0 : a) < (b == std::numeric_limits<int>::max() ? 0 : b);
+                }) - nearest.begin());
+        }
+    }
+
+    // Reverse adjacency is only needed to measure distances *to* a landmark.
+    if (directed) {
+        CsrSnapshot reverse = adjacency.transpose();
+        toLandmark.assign(static_cast<std::size_t>(numNodes) * k, Unreachable);
+        parallelFor(k, parallelWorkers(k, 1), [&](std::size_t begin, std::size_t end, unsigned) {
+            std::vector<int> distance(numNodes);
+            std::vector<int> queue(numNodes);
+            for (std::size_t i = begin; i < end; ++i) {
+                reverse.bfs(chosen[i], distance, queue);
+                for (int v = 0; v < numNodes; ++v) {
+                    toLandmark[static_cast<std::size_t>(v) * k + i] = clamp(distance[v]);
+                }
+            }
+        });
+    }
+}
+
+int LandmarkOracle::landmarkCount() const {
+    return k;
+}
+
+int LandmarkOracle::index(const std::shared_ptr<Node>& node) const {
+    return node ? adjacency.index(node->getID()) : -1;
+}
+
+int LandmarkOracle::lowerBound(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const {
+    int s = index(start);
+    int t = index(end);
+    return s < 0 || t < 0 ? 0 : lowerBound(s, t);
+}
+
+int LandmarkOracle::upperBound(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const {
+    int s = index(start);
+    int t = index(end);
+    return s < 0 || t < 0 ? -1 : upperBound(s, t);
+}
+
+int LandmarkOracle::lowerBound(int start, int end) const {
+    // Triangle inequality: d(L,t) <= d(L,s) + d(s,t) and d(s,L) <= d(s,t) + d(t,L).
+    const std::uint16_t* fromS = fromLandmark.data() + static_cast<std::size_t>(start) * k;
+    const std::uint16_t* fromT = fromLandmark.data() + static_cast<std::size_t>(end) * k;
+    const std::uint16_t* toS = (directed ? toLandmark : fromLandmark).data() + static_cast<std::size_t>(start) * k;
+    const std::uint16_t* toT = (directed ? toLandmark : fromLandmark).data() + static_cast<std::size_t>(end) * k;
+
+    int bound = 0;
+    for (int i = 0; i < k; ++i) {
+        if (fromS[i] != Unreachable && fromT[i] != Unreachable) {
+            bound = std::max(bound, fromT[i] - fromS[i]);
+        }
+        if (toS[i] != Unreachable && toT[i] != Unreachable) {
+            bound = std::max(bound, toS[i] - toT[i]);
+        }
+    }
+    return bound;
+}
+
+int LandmarkOracle::upperBound(int start, int end) const {
+    const std::uint16_t* toS = (directed ? toLandmark : fromLandmark).data() + static_cast<std::size_t>(start) * k;
+    const std::uint16_t* fromT = fromLandmark.data() + static_cast<std::size_t>(end) * k;
+
+    // Saturated entries are only lower estimates, so they can't vouch for a path length.
+    int bound = -1;
+    for (int i = 0; i < k; ++i) {
+        if (toS[i] < Unreachable - 1 && fromT[i] < Unreachable - 1) {
+            int through = toS[i] + fromT[i];
+            if (bound < 0 || through < bound) {
+                bound = through;
+            }
+        }
+    }
+    return bound;
+}
+
+bool LandmarkOracle::provablyUnreachable(int start, int end) const {
+    // If L reaches s but not t, s can't reach t either; likewise if t reaches L but s doesn't.
+    const std::uint16_t* fromS = fromLandmark.data() + static_cast<std::size_t>(start) * k;
+    const std::uint16_t* fromT = fromLandmark.data() + static_cast<std::size_t>(end) * k;
+    const std::uint16_t* toS = (directed ? toLandmark : fromLandmark).data() + static_cast<std::size_t>(start) * k;
+    const std::uint16_t* toT = (directed ? toLandmark : fromLandmark).data() + static_cast<std::size_t>(end) * k;
+
+    for (int i = 0; i < k; ++i) {
+        if ((fromS[i] != Unreachable && fromT[i] == Unreachable) || (toT[i] != Unreachable && toS[i] == Unreachable)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int LandmarkOracle::distance(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const {
+    int s = index(start);
+    int t = index(end);
+    if (s < 0 || t < 0) {
+        return -1;
+    }
+    if (s == t) {
+        return 0;
+    }
+    if (k > 0) {
+        if (provablyUnreachable(s, t)) {
+            return -1;
+        }
+        int lower = lowerBound(s, t);
+        if (lower == upperBound(s, t)) {
+            return lower;
+        }
+    }
+
+    // A* with the landmark bound as heuristic. It is consistent, so the first time
+    // the target is popped its cost is exact. `seen` is stamped per query instead of cleared.
+    if (++epoch == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        epoch = 1;
+    }
+
+    // Ordered by estimate, then deepest first: on grid-like graphs many nodes tie on the
+    // estimate, and preferring the one closest to the target avoids expanding all of them.
+    struct Entry {
+        int estimate;
+        int cost;
+        int node;
+
+        bool operator>(const Entry& other) const {
+            return estimate != other.estimate ? estimate > other.estimate : cost < other.cost;
+        }
+    };
+    const auto& offsets = adjacency.offsets();
+    const auto& targets = adjacency.targets();
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    cost[s] = 0;
+    seen[s] = epoch;
+    open.push({ lowerBound(s, t), 0, s });
+
+    while (!open.empty()) {
+        Entry top = open.top();
+        open.pop();
+        int current = top.node;
+        if (current == t) {
+            return cost[t];
+        }
+        if (top.cost > cost[current]) {
+            continue;  // Stale entry.
+        }
+
+        for (int e = offsets[current]; e < offsets[current + 1]; ++e) {
+            int neighbor = targets[e];
+            int candidate = cost[current] + 1;
+            if (seen[neighbor] != epoch || candidate < cost[neighbor]) {
+                seen[neighbor] = epoch;
+                cost[neighbor] = candidate;
+                open.push({ candidate + lowerBound(neighbor, t), candidate, neighbor });
+            }
+        }
+    }
+
+    return -1;
+}
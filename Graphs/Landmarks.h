@@ -0,0 +1,64 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Csr.h"
+
+class Graph;
+class Node;
+
+// ALT (A*, landmarks, triangle inequality) distance oracle over a snapshot of
+// a graph. Precomputes hop distances between every node and k landmarks;
+// those give O(k) lower/upper bounds for any pair and an admissible
+// heuristic for an exact A* search. Rebuild after the graph changes.
+//
+// Queries reuse internal scratch space, so one oracle must not be queried
+// from several threads at once.
+class LandmarkOracle {
+public:
+    enum Strategy { FarthestLandmarks, DegreeLandmarks };
+
+    LandmarkOracle(const Graph& graph, int landmarks = 16, Strategy strategy = FarthestLandmarks);
+
+    int landmarkCount() const;
+
+    // Never more than the true distance. O(k).
+    int lowerBound(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const;
+
+    // Length of a real path through one landmark, or -1 if no landmark links the pair. O(k).
+    int upperBound(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const;
+
+    // Exact hop distance, or -1 if end is unreachable from start.
+    int distance(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& end) const;
+
+private:
+    // Stored distances saturate below Unreachable; clamping never breaks the bounds.
+    static constexpr std::uint16_t Unreachable = 0xFFFF;
+
+    bool directed;
+    int k = 0;
+    CsrSnapshot adjacency;
+
+    // Node-major: row v holds v's distance from (and, if directed, to) each landmark,
+    // so a query reads two short contiguous rows.
+    std::vector<std::uint16_t> fromLandmark;
+    std::vector<std::uint16_t> toLandmark;
+
+    mutable std::vector<int> cost;
+    mutable std::vector<unsigned> seen;
+    mutable unsigned epoch = 0;
+
+    int index(const std::shared_ptr<Node>& node) const;
+
+    int lowerBound(int start, int end) const;
+
+    int upperBound(int start, int end) const;
+
+    bool provablyUnreachable(int start, int end) const;
+};
+
+
+#endif
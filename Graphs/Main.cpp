@@ -4,37 +4,222 @@
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <random>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <climits>
+#include <cerrno>
 
 #include "Graphs.h"
 #include "Scenes.h"
+#include "Replay.h"
+#include "Ingest.h"
 
-int main() {
-    sf::RenderWindow window(sf::VideoMode(800, 600), "Graph Visualization App");
-    //sf::RenderWindow window(sf::VideoMode(1920, 1080), "Graph Visualization App");
+// Fills the graph with random nodes and edges so sessions can be replayed against a large graph.
+// Seeded, so every replay sees the same graph.
+void populate(Graph& g, int nodeCount, int edgeCount) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> x(0.f, 760.f);
+    std::uniform_real_distribution<float> y(0.f, 560.f);
+
+    std::vector<sf::Vector2f> positions(nodeCount);
+    for (auto& position : positions) {
+        position = sf::Vector2f(x(random), y(random));
+    }
+    int first = g.addNodes(positions);
+
+    std::uniform_int_distribution<int> pick(first, first + nodeCount - 1);
+    std::vector<std::pair<int, int>> pairs(edgeCount);
+    for (auto& pair : pairs) {
+        pair = std::make_pair(pick(random), pick(random));
+    }
+    g.addEdges(pairs);
+}
+
+// Streams random nodes, each linked to an earlier one, from a worker thread the way a
+// live data source would, so merging can be watched while the user keeps editing.
+void feed(IngestQueue& queue, int nodeCount, const std::atomic<bool>& stop) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> x(0.f, 760.f);
+    std::uniform_real_distribution<float> y(0.f, 560.f);
+
+    IngestQueue::Producer producer = queue.producer();
+    std::vector<IngestQueue::NodeRef> staged;
+    staged.reserve(nodeCount);
+    for (int i = 0; i < nodeCount && !stop; ++i) {
+        staged.push_back(producer.addNode(sf::Vector2f(x(random), y(random))));
+        if (i > 0) {
+            std::uniform_int_distribution<int> pick(0, i - 1);
+            producer.addEdge(staged[i], staged[pick(random)]);
+        }
+        if (i % 16 == 15) {
+            producer.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
+
+int usage() {
+    std::cout << "Usage: graphs [--record FILE] [--replay FILE [--realtime] [--offscreen | --no-draw]] [--nodes N [--edges M]] [--feed N]" << std::endl;
+    return 1;
+}
+
+// Accepts a whole non-negative decimal number that fits an int; std::atoi would quietly read "abc" as 0.
+bool parseCount(const char* text, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < 0 || parsed > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string recordPath;
+    std::string replayPath;
+    bool realTime = false;
+    bool offscreen = false;
+    bool drawEach = true;
+    int nodeCount = 0;
+    int edgeCount = 0;
+    int feedCount = 0;
+    bool edgesGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--realtime") {
+            realTime = true;
+        }
+        else if (arg == "--offscreen") {
+            offscreen = true;
+        }
+        else if (arg == "--no-draw") {
+            drawEach = false;
+        }
+        else if (arg == "--nodes" && i + 1 < argc) {
+            if (!parseCount(argv[++i], nodeCount)) {
+                std::cout << "ERROR: --nodes expects a non-negative number, got " << argv[i] << std::endl;
+                return usage();
+            }
+        }
+        else if (arg == "--edges" && i + 1 < argc) {
+            if (!parseCount(argv[++i], edgeCount)) {
+                std::cout << "ERROR: --edges expects a non-negative number, got " << argv[i] << std::endl;
+                return usage();
+            }
+            edgesGiven = true;
+        }
+        else if (arg == "--feed" && i + 1 < argc) {
+            if (!parseCount(argv[++i], feedCount)) {
+                std::cout << "ERROR: --feed expects a non-negative number, got " << argv[i] << std::endl;
+                return usage();
+            }
+        }
+        else {
+            return usage();
+        }
+    }
+
+    if (edgesGiven && nodeCount == 0) {
+        std::cout << "ERROR: --edges needs --nodes with at least one node to connect" << std::endl;
+        return usage();
+    }
 
     Graph g;
+    if (nodeCount > 0) {
+        populate(g, nodeCount, edgeCount);
+    }
 
     SceneManager sceneManager;
-    MainScene* mainScene = new MainScene(sceneManager, g);
-    MenuScene menuScene(sceneManager, mainScene);
+    MainScene mainScene(sceneManager, g);
+    MenuScene menuScene(sceneManager, &mainScene);
 
     sceneManager.setCurrentScene(menuScene);
 
+    if (!replayPath.empty()) {
+        EventReplayer replayer;
+        if (!replayer.load(replayPath)) {
+            return 1;
+        }
+
+        if (offscreen || !drawEach) {
+            // Never created when not drawing: the scenes don't touch the target while handling events.
+            sf::RenderTexture texture;
+            if (drawEach && !texture.create(800, 600)) {
+                std::cout << "ERROR: cannot create offscreen target" << std::endl;
+                return 1;
+            }
+            replayer.run(sceneManager, texture, realTime, drawEach, [&texture]() { texture.display(); });
+        }
+        else {
+            sf::RenderWindow window(sf::VideoMode(800, 600), "Graph Visualization App (replay)");
+            replayer.run(sceneManager, window, realTime, true, [&window]() {
+                sf::Event ignored;
+                while (window.pollEvent(ignored)) {
+                }
+                window.display();
+            });
+        }
+
+        replayer.report();
+        return 0;
+    }
+
+    sf::RenderWindow window(sf::VideoMode(800, 600), "Graph Visualization App");
+    //sf::RenderWindow window(sf::VideoMode(1920, 1080), "Graph Visualization App");
+    window.setFramerateLimit(60);
+
+    std::unique_ptr<EventRecorder> recorder;
+    if (!recordPath.empty()) {
+        recorder = std::make_unique<EventRecorder>(recordPath);
+    }
+
+    // Live sessions only: a feed's timing would make replays unrepeatable.
+    IngestQueue ingest;
+    std::atomic<bool> stopFeed{ false };
+    std::thread feeder;
+    if (feedCount > 0) {
+        mainScene.setIngestQueue(ingest);
+        feeder = std::thread(feed, std::ref(ingest), feedCount, std::cref(stopFeed));
+    }
+
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) { 
+            if (event.type == sf::Event::Closed) {
                 window.close();
             }
-              
+
+            if (recorder) {
+                recorder->record(event);
+            }
 
             sceneManager.handleEvents(event, window);
-            sceneManager.draw(window);
         }
+
+        if (sceneManager.quitRequested()) {
+            window.close();
+        }
+
+        sceneManager.draw(window);
+        window.display();
     }
 
-    delete mainScene;
+    stopFeed = true;
+    if (feeder.joinable()) {
+        feeder.join();
+    }
 
 
     return 0;
-}
\ No newline at end of file
+}
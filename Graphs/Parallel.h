@@ -0,0 +1,74 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Number of threads worth using for `count` items when each thread should get
+// at least `minPerWorker` of them. Small inputs stay on the calling thread.
+inline unsigned parallelWorkers(std::size_t count, std::size_t minPerWorker = 1024) {
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t byWork = std::max<std::size_t>(1, count / std::max<std::size_t>(1, minPerWorker));
+    return static_cast<unsigned>(std::min<std::size_t>(hardware, byWork));
+}
+
+// Splits [0, count) into one contiguous chunk per worker and runs
+// body(begin, end, worker) on each. The calling thread takes chunk 0.
+template <typename Body>
+void parallelFor(std::size_t count, unsigned workers, Body body) {
+    if (workers <= 1 || count == 0) {
+        body(std::size_t(0), count, 0u);
+        return;
+    }
+
+    std::size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned worker = 1; worker < workers; ++worker) {
+        std::size_t begin = std::min(count, worker * chunk);
+        std::size_t end = std::min(count, begin + chunk);
+        threads.emplace_back([&body, begin, end, worker]() { body(begin, end, worker); });
+    }
+    body(std::size_t(0), std::min(count, chunk), 0u);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Sorts each worker's chunk independently, then merges neighbouring runs
+// pairwise until one run is left. Each merge round also runs in parallel.
+template <typename T>
+void parallelSort(std::vector<T>& values) {
+    unsigned workers = parallelWorkers(values.size(), 1 << 16);
+    if (workers <= 1) {
+        std::sort(values.begin(), values.end());
+        return;
+    }
+
+    std::size_t chunk = (values.size() + workers - 1) / workers;
+    parallelFor(workers, workers, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t run = begin; run < end; ++run) {
+            std::size_t first = std::min(values.size(), run * chunk);
+            std::size_t last = std::min(values.size(), first + chunk);
+            std::sort(values.begin() + first, values.begin() + last);
+        }
+    });
+
+    for (std::size_t width = chunk; width < values.size(); width *= 2) {
+        std::size_t merges = (values.size() + 2 * width - 1) / (2 * width);
+        parallelFor(merges, static_cast<unsigned>(std::min<std::size_t>(merges, workers)), [&](std::size_t begin, std::size_t end, unsigned) {
+            for (std::size_t merge = begin; merge < end; ++merge) {
+                std::size_t first = merge * 2 * width;
+                std::size_t middle = std::min(values.size(), first + width);
+                std::size_t last = std::min(values.size(), first + 2 * width);
+                std::inplace_merge(values.begin() + first, values.begin() + middle, values.begin() + last);
+            }
+        });
+    }
+}
+
+
+#endif
@@ -0,0 +1,348 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+#include "Graphs.h"
+#include "Scenes.h"
+#include "Replay.h"
+#include "Export.h"
+
+namespace {
+
+const char Magic[4] = { 'G', 'E', 'V', 'T' };
+constexpr char Version = 1;
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, std::int64_t value) {
+    putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void putFloat(std::string& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putVarint(out, bits);
+}
+
+class LogReader {
+public:
+    LogReader(const std::string& data, std::size_t position) : data(data), position(position) {
+    }
+
+    bool atEnd() const {
+        return position >= data.size();
+    }
+
+    bool ok() const {
+        return !failed;
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (atEnd()) {
+                failed = true;
+                return 0;
+            }
+            std::uint8_t byte = static_cast<std::uint8_t>(data[position++]);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    std::int64_t signedVarint() {
+        std::uint64_t value = varint();
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    float floatValue() {
+        std::uint32_t bits = static_cast<std::uint32_t>(varint());
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    const std::string& data;
+    std::size_t position;
+    bool failed = false;
+};
+
+const char* eventName(int type) {
+    static const char* const names[] = {
+        "Closed", "Resized", "LostFocus", "GainedFocus", "TextEntered", "KeyPressed", "KeyReleased",
+        "MouseWheelMoved", "MouseWheelScrolled", "MouseButtonPressed", "MouseButtonReleased", "MouseMoved",
+        "MouseEntered", "MouseLeft"
+    };
+    return type >= 0 && type < static_cast<int>(std::size(names)) ? names[type] : "Other";
+}
+
+double elapsedMicros(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+void printRow(OutputBuffer& out, const char* name, std::vector<double> samples) {
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    auto percentile = [&](double q) {
+        return samples[std::min(samples.size() - 1, static_cast<std::size_t>(q * (samples.size() - 1) + 0.5))];
+    };
+
+    out << name << ": count " << samples.size()
+        << ", mean " << static_cast<float>(total / samples.size())
+        << ", p50 " << static_cast<float>(percentile(0.50))
+        << ", p95 " << static_cast<float>(percentile(0.95))
+        << ", p99 " << static_cast<float>(percentile(0.99))
+        << ", max " << static_cast<float>(samples.back()) << " us\n";
+}
+
+}
+
+EventRecorder::EventRecorder(const std::string& path) : file(path, std::ios::binary | std::ios::trunc) {
+    if (!file) {
+        std::cout << "ERROR: cannot open " << path << std::endl;
+        return;
+    }
+    pending.append(Magic, sizeof(Magic));
+    pending.push_back(Version);
+}
+
+EventRecorder::~EventRecorder() {
+    flush();
+}
+
+bool EventRecorder::good() const {
+    return static_cast<bool>(file);
+}
+
+void EventRecorder::record(const sf::Event& event) {
+    if (!file) {
+        return;
+    }
+
+    std::string payload;
+    switch (event.type) {
+    case sf::Event::Closed:
+    case sf::Event::LostFocus:
+    case sf::Event::GainedFocus:
+    case sf::Event::MouseEntered:
+    case sf::Event::MouseLeft:
+        break;
+    case sf::Event::Resized:
+        putVarint(payload, event.size.width);
+        putVarint(payload, event.size.height);
+        break;
+    case sf::Event::TextEntered:
+        putVarint(payload, event.text.unicode);
+        break;
+    case sf::Event::KeyPressed:
+    case sf::Event::KeyReleased:
+        putSigned(payload, event.key.code);
+        putVarint(payload, (event.key.alt ? 1u : 0u) | (event.key.control ? 2u : 0u) | (event.key.shift ? 4u : 0u) | (event.key.system ? 8u : 0u));
+        break;
+    case sf::Event::MouseWheelMoved:
+        putSigned(payload, event.mouseWheel.delta);
+        putSigned(payload, event.mouseWheel.x);
+        putSigned(payload, event.mouseWheel.y);
+        break;
+    case sf::Event::MouseWheelScrolled:
+        putVarint(payload, event.mouseWheelScroll.wheel);
+        putFloat(payload, event.mouseWheelScroll.delta);
+        putSigned(payload, event.mouseWheelScroll.x);
+        putSigned(payload, event.mouseWheelScroll.y);
+        break;
+    case sf::Event::MouseButtonPressed:
+    case sf::Event::MouseButtonReleased:
+        putVarint(payload, event.mouseButton.button);
+        putSigned(payload, event.mouseButton.x);
+        putSigned(payload, event.mouseButton.y);
+        break;
+    case sf::Event::MouseMoved:
+        putSigned(payload, event.mouseMove.x);
+        putSigned(payload, event.mouseMove.y);
+        break;
+    default:
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::uint64_t delay = started ? static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - last).count()) : 0;
+    last = now;
+    started = true;
+
+    putVarint(pending, delay);
+    pending.push_back(static_cast<char>(event.type));
+    pending += payload;
+
+    if (pending.size() >= (1 << 16)) {
+        flush();
+    }
+}
+
+void EventRecorder::flush() {
+    if (file && !pending.empty()) {
+        file.write(pending.data(), pending.size());
+        file.flush();
+    }
+    pending.clear();
+}
+
+bool EventReplayer::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "ERROR: cannot open " << path << std::endl;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(Magic) + 1 || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0 || data[sizeof(Magic)] != Version) {
+        std::cout << "ERROR: " << path << " is not an event log" << std::endl;
+        return false;
+    }
+
+    events.clear();
+    LogReader reader(data, sizeof(Magic) + 1);
+    while (!reader.atEnd()) {
+        TimedEvent timed;
+        timed.delay = reader.varint();
+        if (reader.atEnd()) {
+            break;
+        }
+        std::memset(&timed.event, 0, sizeof(timed.event));
+        timed.event.type = static_cast<sf::Event::EventType>(reader.varint());
+
+        sf::Event& event = timed.event;
+        switch (event.type) {
+        case sf::Event::Closed:
+        case sf::Event::LostFocus:
+        case sf::Event::GainedFocus:
+        case sf::Event::MouseEntered:
+        case sf::Event::MouseLeft:
+            break;
+        case sf::Event::Resized:
+            event.size.width = static_cast<unsigned int>(reader.varint());
+            event.size.height = static_cast<unsigned int>(reader.varint());
+            break;
+        case sf::Event::TextEntered:
+            event.text.unicode = static_cast<sf::Uint32>(reader.varint());
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            event.key.code = static_cast<sf::Keyboard::Key>(reader.signedVarint());
+            std::uint64_t modifiers = reader.varint();
+            event.key.alt = (modifiers & 1) != 0;
+            event.key.control = (modifiers & 2) != 0;
+            event.key.shift = (modifiers & 4) != 0;
+            event.key.system = (modifiers & 8) != 0;
+            break;
+        }
+        case sf::Event::MouseWheelMoved:
+            event.mouseWheel.delta = static_cast<int>(reader.signedVarint());
+            event.mouseWheel.x = static_cast<int>(reader.signedVarint());
+            event.mouseWheel.y = static_cast<int>(reader.signedVarint());
+            break;
+        case sf::Event::MouseWheelScrolled:
+            event.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(reader.varint());
+            event.mouseWheelScroll.delta = reader.floatValue();
+            event.mouseWheelScroll.x = static_cast<int>(reader.signedVarint());
+            event.mouseWheelScroll.y = static_cast<int>(reader.signedVarint());
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(reader.varint());
+            event.mouseButton.x = static_cast<int>(reader.signedVarint());
+            event.mouseButton.y = static_cast<int>(reader.signedVarint());
+            break;
+        case sf::Event::MouseMoved:
+            event.mouseMove.x = static_cast<int>(reader.signedVarint());
+            event.mouseMove.y = static_cast<int>(reader.signedVarint());
+            break;
+        default:
+            std::cout << "ERROR: unknown event type in " << path << std::endl;
+            return false;
+        }
+
+        if (!reader.ok()) {
+            std::cout << "ERROR: " << path << " is truncated" << std::endl;
+            return false;
+        }
+        events.push_back(timed);
+    }
+
+    return true;
+}
+
+std::size_t EventReplayer::size() const {
+    return events.size();
+}
+
+void EventReplayer::run(SceneManager& sceneManager, sf::RenderTarget& target, bool realTime, bool drawEach, const std::function<void()>& present) {
+    using Clock = std::chrono::steady_clock;
+
+    handleLatency.assign(sf::Event::Count, {});
+    drawLatency.clear();
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point due = start;
+    for (const auto& timed : events) {
+        if (sceneManager.quitRequested()) {
+            break;
+        }
+        if (realTime) {
+            due += std::chrono::microseconds(timed.delay);
+            std::this_thread::sleep_until(due);
+        }
+
+        Clock::time_point before = Clock::now();
+        sceneManager.handleEvents(timed.event, target);
+        Clock::time_point handled = Clock::now();
+        handleLatency[timed.event.type].push_back(elapsedMicros(before, handled));
+
+        if (drawEach) {
+            sceneManager.draw(target);
+            if (present) {
+                present();
+            }
+            drawLatency.push_back(elapsedMicros(handled, Clock::now()));
+        }
+    }
+
+    wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void EventReplayer::report() const {
+    std::fflush(stdout);
+    OutputBuffer out(1);
+
+    std::vector<double> all;
+    for (std::size_t type = 0; type < handleLatency.size(); ++type) {
+        printRow(out, eventName(static_cast<int>(type)), handleLatency[type]);
+        all.insert(all.end(), handleLatency[type].begin(), handleLatency[type].end());
+    }
+    printRow(out, "All events", all);
+    printRow(out, "Draw", drawLatency);
+    out << "Replayed " << all.size() << " of " << events.size() << " events in " << static_cast<float>(wallTime) << " s\n";
+    out << "-------------------\n";
+}
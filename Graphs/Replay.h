@@ -0,0 +1,72 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+class SceneManager;
+
+// Input log format: the bytes "GEVT", a version byte, then one record per
+// event: varint microseconds since the previous event, a type byte and a
+// type-specific payload of varints (zigzag for signed fields). Events the
+// scenes never look at (joystick, touch, sensor) are not recorded.
+
+// Appends window events to a log as they are polled.
+class EventRecorder {
+public:
+    explicit EventRecorder(const std::string& path);
+
+    ~EventRecorder();
+
+    bool good() const;
+
+    void record(const sf::Event& event);
+
+    void flush();
+
+private:
+    std::ofstream file;
+    std::string pending;
+    std::chrono::steady_clock::time_point last;
+    bool started = false;
+};
+
+struct TimedEvent {
+    std::uint64_t delay;  // Microseconds since the previous event
+    sf::Event event;
+};
+
+// Feeds a recorded log back through SceneManager::handleEvents and reports
+// per-event latency. Drawing is optional, so a replay can run against a
+// window, an offscreen sf::RenderTexture or nothing at all.
+class EventReplayer {
+public:
+    // Returns false and prints an error if the log is missing or malformed.
+    bool load(const std::string& path);
+
+    std::size_t size() const;
+
+    // With realTime, waits out the recorded gaps; otherwise runs back to back.
+    // With drawEach, every event is followed by a draw into `target` and a call to
+    // `present` (e.g. display()), timed separately. Stops early if a scene requests quit.
+    void run(SceneManager& sceneManager, sf::RenderTarget& target, bool realTime, bool drawEach, const std::function<void()>& present = nullptr);
+
+    // Prints count, mean, p50, p95, p99 and max latency per event type.
+    void report() const;
+
+private:
+    std::vector<TimedEvent> events;
+
+    // Per sf::Event::EventType, in microseconds.
+    std::vector<std::vector<double>> handleLatency;
+    std::vector<double> drawLatency;
+    double wallTime = 0.0;
+};
+
+
+#endif
@@ -10,6 +10,9 @@
 #include "Graphs.h"
 #include "Scenes.h"
 #include "Font.h"
+#include "Analytics.h"
+#include "Export.h"
+#include "Ingest.h"
 
 
 
@@ -18,13 +21,21 @@ void SceneManager::setCurrentScene(Scene& scene) {
     currentScene = &scene;
 }
 
-void SceneManager::handleEvents(sf::Event event, sf::RenderWindow& window) {
-    currentScene->handleEvents(event, window);
+void SceneManager::handleEvents(sf::Event event, sf::RenderTarget& target) {
+    currentScene->handleEvents(event, target);
     
 }
 
-void SceneManager::draw(sf::RenderWindow& window) {
-    currentScene->draw(window);
+void SceneManager::draw(sf::RenderTarget& target) {
+    currentScene->draw(target);
+}
+
+void SceneManager::requestQuit() {
+    quit = true;
+}
+
+bool SceneManager::quitRequested() const {
+    return quit;
 }
 
 
@@ -38,191 +49,258 @@ void MainScene::setGraph(Graph& g) {
 }
 
 void MainScene::setSceneManager(SceneManager& sceneManager) {
-    this->sceneManager = sceneManager;
+    this->sceneManager = &sceneManager;
+}
+
+void MainScene::setIngestQueue(IngestQueue& ingest) {
+    this->ingest = &ingest;
 }
 
-void MainScene::handleEvents(sf::Event event, sf::RenderWindow& window) {
-    bool clicked = false;
-    while (window.isOpen()) {
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
+void MainScene::handleEvents(sf::Event event, sf::RenderTarget&) {
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::C) {
+            g.clear();
+            if (ingest) {
+                ingest->reset();
             }
-            else if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::C) {
-                    g.clear();
-                    g.setSearchStartNode(nullptr);
-                    g.setSearchEndNode(nullptr);
-                        
-                }
-                else if (event.key.code == sf::Keyboard::I) {
-                    g.info();
-                    if (g.getSearchStartNode() && g.getSearchEndNode()) {
-                        std::cout << "Start Node is: " << g.getSearchStartNode()->getID() << std::endl;
-                        std::cout << "End Node is: " << g.getSearchEndNode()->getID() << std::endl;
-                    }
-                }
-                else if (event.key.code == sf::Keyboard::Z && event.key.control) {
-                    g.undo();
-                }
-                else if (event.key.code == sf::Keyboard::Escape) {
-                    exit(0);
-                }
+            g.setSearchStartNode(nullptr);
+            g.setSearchEndNode(nullptr);
+                
+        }
+        else if (event.key.code == sf::Keyboard::I) {
+            g.info();
+            if (g.getSearchStartNode() && g.getSearchEndNode()) {
+                std::cout << "Start Node is: " << g.getSearchStartNode()->getID() << std::endl;
+                std::cout << "End Node is: " << g.getSearchEndNode()->getID() << std::endl;
             }
-            else if (event.type == sf::Event::MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Right) {
-                    sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
-                    g.addNode(mousePosition);
+        }
+        else if (event.key.code == sf::Keyboard::Z && event.key.control) {
+            g.undo();
+        }
+        else if (event.key.code == sf::Keyboard::E) {
+            for (ExportFormat format : { DotFormat, GraphMLFormat, EdgeListFormat, JsonFormat }) {
+                std::string path = std::string("graph") + exportExtension(format);
+                if (exportGraph(g, format, path)) {
+                    std::cout << "Exported " << path << std::endl;
                 }
             }
-
         }
+        else if (event.key.code == sf::Keyboard::L) {
+            sf::Clock clock;
+            g.buildDistanceOracle();
+            std::cout << "Distance oracle built in " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+        }
+        else if (event.key.code == sf::Keyboard::A) {
+            metric = static_cast<Metric>((metric + 1) % (BetweennessMetric + 1));
+            showMetric();
+        }
+        else if (event.key.code == sf::Keyboard::Escape) {
+            sceneManager->requestQuit();
+        }
+    }
+    else if (event.type == sf::Event::MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Right) {
+            sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
+            g.addNode(mousePosition);
+        }
+    }
 
-        sf::Vector2f mousePosition = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+    const std::vector<std::shared_ptr<Node>>& nodes = g.getNodes();
 
-        const std::vector<std::shared_ptr<Node>> nodes = g.getNodes();
+    if (event.type == sf::Event::MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Middle && !clicked) {
+            sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
 
-        for (auto& node : nodes) {
-            sf::CircleShape circle = node->getCircle();
-            sf::Vector2f position = circle.getPosition();
-            float radius = circle.getRadius();
-            float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
-        }
-        
-
-
-        if (event.type == sf::Event::MouseButtonPressed) {
-            if (event.mouseButton.button == sf::Mouse::Middle && !clicked) {
-                for (auto& node : nodes) {
-                    sf::CircleShape circle = node->getCircle();
-                    sf::Vector2f position = circle.getPosition();
-                    float radius = circle.getRadius();
-                    float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
-                    if (distance <= radius) {
-                        clicked = true;
-                        if (circle.getFillColor() == sf::Color::Red) {
-                            circle.setFillColor(sf::Color::Yellow);
-                            node->setCircle(circle);
-                            std::shared_ptr<Node> previousNode;
-                            if (!g.getSearchStartNode()) {
-                                g.setSearchStartNode(node);
-                                previousNode = node;
-                            }
-                            else if (g.getSearchStartNode() && !g.getSearchEndNode()) {
-                                g.setSearchEndNode(node);
-                            }
-                            else if (g.getSearchStartNode() && g.getSearchEndNode()) {
-                                g.setSearchStartNode(node);
-                                g.setSearchEndNode(previousNode);
-                            }
+            for (auto& node : nodes) {
+                sf::CircleShape circle = node->getCircle();
+                sf::Vector2f position = circle.getPosition();
+                float radius = circle.getRadius();
+                float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
+                if (distance <= radius) {
+                    clicked = true;
+                    if (circle.getFillColor() == sf::Color::Red) {
+                        circle.setFillColor(sf::Color::Yellow);
+                        node->setCircle(circle);
+                        std::shared_ptr<Node> previousNode;
+                        if (!g.getSearchStartNode()) {
+                            g.setSearchStartNode(node);
+                            previousNode = node;
                         }
-                        if (circle.getFillColor() == sf::Color::Yellow) {
-                            node->setCircle(circle);
+                        else if (g.getSearchStartNode() && !g.getSearchEndNode()) {
+                            g.setSearchEndNode(node);
                         }
-                        else {
-                            circle.setFillColor(sf::Color::Red);
-                            node->setCircle(circle);
+                        else if (g.getSearchStartNode() && g.getSearchEndNode()) {
+                            g.setSearchStartNode(node);
+                            g.setSearchEndNode(previousNode);
                         }
                     }
-                    else if (g.getSearchStartNode() && g.getSearchEndNode()) {
-                        circle.setFillColor(sf::Color::White);
+                    if (circle.getFillColor() == sf::Color::Yellow) {
                         node->setCircle(circle);
                     }
-                }
-                
-            }
-            else if (event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
-
-                for (auto& node : nodes) {
-                    sf::CircleShape circle = node->getCircle();
-                    sf::Vector2f position = circle.getPosition();
-                    float radius = circle.getRadius();
-                    float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
-                    if (distance <= radius) {
-                        if (circle.getFillColor() == sf::Color::Red) {
-                            node->setCircle(circle);
-                            g.setStartingNode(node);
-                        }
-                        if (circle.getFillColor() == sf::Color::Yellow) {
-                            g.setStartingNode(node);
-                            node->setCircle(circle);
-                        }
-                        else {
-                            circle.setFillColor(sf::Color::Red);
-                            node->setCircle(circle);
-                            g.setStartingNode(node);
-                        }
+                    else {
+                        circle.setFillColor(sf::Color::Red);
+                        node->setCircle(circle);
                     }
                 }
+                else if (g.getSearchStartNode() && g.getSearchEndNode()) {
+                    circle.setFillColor(sf::Color::White);
+                    node->setCircle(circle);
+                }
             }
+            
         }
-        else if (event.type == sf::Event::MouseMoved) {
-            sf::Vector2f mousePosition = sf::Vector2f(event.mouseMove.x, event.mouseMove.y);
+        else if (event.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
 
             for (auto& node : nodes) {
                 sf::CircleShape circle = node->getCircle();
                 sf::Vector2f position = circle.getPosition();
                 float radius = circle.getRadius();
                 float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
-
                 if (distance <= radius) {
+                    if (circle.getFillColor() == sf::Color::Red) {
+                        node->setCircle(circle);
+                        g.setStartingNode(node);
+                    }
                     if (circle.getFillColor() == sf::Color::Yellow) {
-                        circle.setFillColor(sf::Color::Yellow);
+                        g.setStartingNode(node);
                         node->setCircle(circle);
                     }
                     else {
                         circle.setFillColor(sf::Color::Red);
                         node->setCircle(circle);
+                        g.setStartingNode(node);
                     }
                 }
+            }
+        }
+    }
+    else if (event.type == sf::Event::MouseMoved) {
+        sf::Vector2f mousePosition = sf::Vector2f(event.mouseMove.x, event.mouseMove.y);
+
+        for (auto& node : nodes) {
+            sf::CircleShape circle = node->getCircle();
+            sf::Vector2f position = circle.getPosition();
+            float radius = circle.getRadius();
+            float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
+
+            if (distance <= radius) {
+                if (circle.getFillColor() == sf::Color::Yellow) {
+                    circle.setFillColor(sf::Color::Yellow);
+                    node->setCircle(circle);
+                }
                 else {
-                    if (circle.getFillColor() != sf::Color::Yellow) {
-                        circle.setFillColor(sf::Color::White);
-                        node->setCircle(circle);
-                    }
+                    circle.setFillColor(sf::Color::Red);
+                    node->setCircle(circle);
+                }
+            }
+            else {
+                if (circle.getFillColor() != sf::Color::Yellow) {
+                    circle.setFillColor(sf::Color::White);
+                    node->setCircle(circle);
                 }
             }
         }
-        else if (event.type == sf::Event::MouseButtonReleased) {
-            if (event.mouseButton.button == sf::Mouse::Left || event.mouseButton.button == sf::Mouse::Middle) {
-                sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
-
-                for (auto& node : nodes) {
-                    sf::CircleShape circle = node->getCircle();
-                    sf::Vector2f position = circle.getPosition();
-                    float radius = circle.getRadius();
-                    float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
-
-                    if (distance <= radius) {
-                        clicked = false;
-                        node->setCircle(circle);
-                        g.addEdgeIfValid(node); // Add the edge if a valid node is under the mouse position
+    }
+    else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Left || event.mouseButton.button == sf::Mouse::Middle) {
+            sf::Vector2f mousePosition = sf::Vector2f(event.mouseButton.x, event.mouseButton.y);
 
-                        if (circle.getFillColor() == sf::Color::Red) {
-                            circle.setFillColor(sf::Color::Yellow);
-                        }
-                        else {
-                            circle.setFillColor(sf::Color::Red);
-                        }
-                        
+            for (auto& node : nodes) {
+                sf::CircleShape circle = node->getCircle();
+                sf::Vector2f position = circle.getPosition();
+                float radius = circle.getRadius();
+                float distance = std::sqrt(std::pow(mousePosition.x - position.x - radius, 2) + std::pow(mousePosition.y - position.y - radius, 2));
+
+                if (distance <= radius) {
+                    clicked = false;
+                    node->setCircle(circle);
+                    g.addEdgeIfValid(node); // Add the edge if a valid node is under the mouse position
+
+                    if (circle.getFillColor() == sf::Color::Red) {
+                        circle.setFillColor(sf::Color::Yellow);
+                    }
+                    else {
+                        circle.setFillColor(sf::Color::Red);
                     }
+                    
                 }
             }
         }
+    }
+}
 
+void MainScene::draw(sf::RenderTarget& target) {
+    // Once per frame is the safe point for producers' nodes and edges. Bounded so a
+    // burst can't stall a frame.
+    if (ingest) {
+        ingest->mergeInto(g, 1 << 16);
+    }
 
+    target.clear(sf::Color::Black);
 
-        this->draw(window);
-    }
+    g.draw(target);
 }
 
-void MainScene::draw(sf::RenderWindow& window) {
-    window.clear(sf::Color::Black);
+void MainScene::showMetric() {
+    constexpr float baseRadius = 20.f;
+    const auto& nodes = g.getNodes();
+
+    std::vector<double> scores;
+    Analytics analytics(g);
+    switch (metric) {
+    case PageRankMetric:
+        std::cout << "Showing: PageRank" << std::endl;
+        scores = analytics.pageRank();
+        break;
+    case DegreeMetric:
+        std::cout << "Showing: Degree centrality" << std::endl;
+        scores = analytics.degreeCentrality();
+        break;
+    case ClosenessMetric:
+        std::cout << "Showing: Closeness centrality" << std::endl;
+        scores = analytics.closenessCentrality();
+        break;
+    case BetweennessMetric:
+        std::cout << "Showing: Betweenness centrality" << std::endl;
+        scores = analytics.betweennessCentrality();
+        break;
+    default:
+        std::cout << "Showing: None" << std::endl;
+        break;
+    }
+
+    double highest = 0.0;
+    for (double score : scores) {
+        highest = std::max(highest, score);
+    }
+
+    std::fflush(stdout);
+    OutputBuffer out(1);
+
+    // Scale each node around its centre and shade its outline from blue (low) to magenta (high).
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        sf::CircleShape circle = nodes[i]->getCircle();
+        sf::Vector2f centre = circle.getPosition() + sf::Vector2f(circle.getRadius(), circle.getRadius());
 
-    g.draw(window);
+        float radius = baseRadius;
+        if (scores.empty()) {
+            circle.setOutlineThickness(2.f);
+            circle.setOutlineColor(sf::Color::Black);
+        }
+        else {
+            float weight = highest > 0.0 ? static_cast<float>(scores[i] / highest) : 0.f;
+            radius = baseRadius * (0.75f + 0.75f * weight);
+            circle.setOutlineThickness(4.f);
+            circle.setOutlineColor(sf::Color(static_cast<sf::Uint8>(255 * weight), 0, 255));
+            out << "Node " << nodes[i]->getID() << ": " << scores[i] << '\n';
+        }
 
-    window.display();
+        circle.setRadius(radius);
+        circle.setPosition(centre - sf::Vector2f(radius, radius));
+        nodes[i]->setCircle(circle);
+    }
+    out << "-------------------\n";
 }
 
 MenuScene::MenuScene(SceneManager& sceneManager, MainScene* mainScene) {
@@ -257,21 +335,19 @@ void MenuScene::setSceneManager(SceneManager& sceneManager) {
     this->sceneManager = &sceneManager;
 }
 
-void MenuScene::handleEvents(sf::Event event, sf::RenderWindow& window) {
+void MenuScene::handleEvents(sf::Event event, sf::RenderTarget&) {
     if (event.type == sf::Event::MouseButtonPressed) {
-        sf::Vector2i mousePosition = sf::Mouse::getPosition(window);
+        sf::Vector2i mousePosition(event.mouseButton.x, event.mouseButton.y);
         if (button.getGlobalBounds().contains(mousePosition.x, mousePosition.y)) {
             sceneManager->setCurrentScene(*mainScene);  // Transition to the main scene
         }
     }
 }
 
-void MenuScene::draw(sf::RenderWindow& window) {
-    window.clear(sf::Color::Black);
-
-    window.draw(titleText);
-    window.draw(button);
-    window.draw(buttonText);
+void MenuScene::draw(sf::RenderTarget& target) {
+    target.clear(sf::Color::Black);
 
-    window.display();
+    target.draw(titleText);
+    target.draw(button);
+    target.draw(buttonText);
 }
@@ -3,26 +3,37 @@
 
 #include <SFML/Graphics.hpp>
 
+// Scenes handle one event at a time and draw into any render target; the
+// owner of the window polls events and calls display().
 class Scene {
 public:
-    virtual void handleEvents(sf::Event event, sf::RenderWindow& window) = 0;
-    virtual void draw(sf::RenderWindow& window) = 0;
+    virtual ~Scene() = default;
+
+    virtual void handleEvents(sf::Event event, sf::RenderTarget& target) = 0;
+    virtual void draw(sf::RenderTarget& target) = 0;
 };
 
 class MainScene;
 
+class IngestQueue;
+
 class MenuScene;
 
 class SceneManager {
 private:
     Scene* currentScene;
+    bool quit = false;
 
 public:
     void setCurrentScene(Scene& scene);
 
-    void handleEvents(sf::Event event, sf::RenderWindow& window);
+    void handleEvents(sf::Event event, sf::RenderTarget& target);
+
+    void draw(sf::RenderTarget& target);
 
-    void draw(sf::RenderWindow& window);
+    void requestQuit();
+
+    bool quitRequested() const;
 };
 
 class MainScene : public Scene {
@@ -33,13 +44,24 @@ public:
 
     void setSceneManager(SceneManager& sceneManager);
 
-    void handleEvents(sf::Event event, sf::RenderWindow& window) override;
+    // Nodes and edges staged by producer threads are merged into the graph once per frame.
+    void setIngestQueue(IngestQueue& ingest);
+
+    void handleEvents(sf::Event event, sf::RenderTarget& target) override;
 
-    void draw(sf::RenderWindow& window) override;
+    void draw(sf::RenderTarget& target) override;
 
 private:
     Graph g;
-    SceneManager sceneManager;
+    SceneManager* sceneManager;
+    IngestQueue* ingest = nullptr;
+    bool clicked = false;
+
+    enum Metric { NoMetric, PageRankMetric, DegreeMetric, ClosenessMetric, BetweennessMetric };
+
+    Metric metric = NoMetric;
+
+    void showMetric();
 };
 
 class MenuScene : public Scene {
@@ -48,9 +70,9 @@ public:
 
     void setSceneManager(SceneManager& sceneManager);
 
-    void handleEvents(sf::Event event, sf::RenderWindow& window) override;
+    void handleEvents(sf::Event event, sf::RenderTarget& target) override;
 
-    void draw(sf::RenderWindow& window) override;
+    void draw(sf::RenderTarget& target) override;
 
 private:
     SceneManager* sceneManager;